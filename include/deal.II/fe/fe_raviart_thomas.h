@@ -23,6 +23,9 @@
 #include <deal.II/fe/fe.h>
 #include <deal.II/fe/fe_poly_tensor.h>
 
+#include <array>
+#include <cstdint>
+#include <map>
 #include <vector>
 
 DEAL_II_NAMESPACE_OPEN
@@ -344,8 +347,16 @@ class FE_RaviartThomasNodal : public FE_PolyTensor<dim>
 public:
   /**
    * Constructor for the Raviart-Thomas element of degree @p p.
+   *
+   * If @p precompute_transfer_matrices is set, the prolongation and
+   * restriction matrices for isotropic refinement are computed in the
+   * constructor rather than lazily upon first request. By default, the
+   * first multigrid or refinement step pays this one-off cost while all
+   * worker threads serialize behind the initialization mutex; applications
+   * that know they will refine can move it into element setup instead.
    */
-  FE_RaviartThomasNodal(const unsigned int p);
+  FE_RaviartThomasNodal(const unsigned int p,
+                        const bool         precompute_transfer_matrices = false);
 
   /**
    * Return a string that uniquely identifies a finite element. This class
@@ -423,6 +434,64 @@ private:
   void
   initialize_quad_dof_index_permutation_and_sign_change();
 
+  /**
+   * Common implementation of get_face_interpolation_matrix() and
+   * get_subface_interpolation_matrix(), which only differ in the projection
+   * of the support points. A @p subface equal to
+   * numbers::invalid_unsigned_int selects the projection to the whole face.
+   */
+  void
+  fill_face_interpolation_matrix(const FiniteElement<dim> &x_source_fe,
+                                 const unsigned int        subface,
+                                 FullMatrix<double> &      interpolation_matrix,
+                                 const unsigned int        face_no) const;
+
+  /**
+   * For each degree of freedom, the vector component that gets evaluated at
+   * its generalized support point when interpolating: the normal direction
+   * of the owning face for face dofs, and the component of the owning chunk
+   * for interior dofs. Set up once in the constructor so that
+   * convert_generalized_support_point_values_to_dof_values() reduces to a
+   * single table-driven loop over all dofs instead of a per-face dispatch.
+   */
+  std::vector<unsigned int> dof_evaluation_component;
+
+  /**
+   * Bit matrix for has_support_on_face(): bit @p f of entry @p i is set if
+   * shape function @p i has support on face @p f. Built once in the
+   * constructor; the six faces of a hexahedron fit comfortably into one
+   * byte per shape function. This turns the per-call integer division into
+   * a single load, shift and mask.
+   */
+  std::vector<std::uint8_t> support_on_face_mask;
+
+  /**
+   * Tolerance used by fill_face_interpolation_matrix() when snapping matrix
+   * entries close to 0 or 1 to those exact values, and by the corresponding
+   * debug row-sum check. It only depends on the degree and the dimension,
+   * so it is computed once in the constructor.
+   */
+  double interp_snap_eps;
+
+  /**
+   * Cache for the matrices computed by get_face_interpolation_matrix() and
+   * get_subface_interpolation_matrix(). The matrix only depends on the
+   * degree of the source element, the face and the subface (the latter is
+   * numbers::invalid_unsigned_int for the face case), and the hp machinery
+   * requests the same few combinations over and over while distributing
+   * degrees of freedom. Access is guarded by #face_interpolation_mutex.
+   */
+  mutable std::map<std::array<unsigned int, 3>, FullMatrix<double>>
+    face_interpolation_cache;
+
+  /**
+   * Mutex guarding #face_interpolation_cache. Deliberately separate from
+   * #mutex: a cache lookup must not wait behind the much more expensive
+   * computation of the restriction and embedding matrices held under that
+   * lock by another thread.
+   */
+  mutable Threads::Mutex face_interpolation_mutex;
+
   /*
    * Mutex for protecting initialization of restriction and embedding matrix.
    */
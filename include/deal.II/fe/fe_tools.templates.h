@@ -2162,20 +2162,26 @@ namespace FETools
         tr.begin_active()->set_refine_flag(RefinementCase<dim>(ref_case));
         tr.execute_coarsening_and_refinement();
 
-        FEValues<dim, spacedim> fine(mapping,
-                                     fe,
-                                     q_fine,
-                                     update_quadrature_points |
-                                       update_JxW_values | update_values);
-
         typename Triangulation<dim, spacedim>::cell_iterator coarse_cell =
           tr.begin(0);
 
-        Vector<number> v_coarse(n);
-        Vector<number> v_fine(n);
-
+        // the children are independent of each other, and in the common
+        // isotropic-only invocation the loop over refinement cases below
+        // consists of a single task, so distribute the per-child work onto
+        // tasks of its own; each child needs its own FEValues object and
+        // scratch vectors
+        Threads::TaskGroup<> child_tasks;
         for (unsigned int cell_number = 0; cell_number < nc; ++cell_number)
-          {
+          child_tasks += Threads::new_task([&, cell_number]() {
+            FEValues<dim, spacedim> fine(mapping,
+                                         fe,
+                                         q_fine,
+                                         update_quadrature_points |
+                                           update_JxW_values | update_values);
+
+            Vector<number> v_coarse(n);
+            Vector<number> v_fine(n);
+
             FullMatrix<double> &this_matrix = matrices[cell_number];
 
             // Compute right hand side, which is a fine level basis
@@ -2238,7 +2244,9 @@ namespace FETools
               for (unsigned int j = 0; j < this_matrix.n(); ++j)
                 if (std::fabs(this_matrix(i, j)) < 1e-12)
                   this_matrix(i, j) = 0.;
-          }
+          });
+
+        child_tasks.join_all();
       };
 
 
@@ -58,6 +58,11 @@ class LAPACKFullMatrix;
  * argument to functions. If there is no argument with a number type, the
  * matrix number type is used.
  *
+ * The entries are stored row-major in an AlignedVector inherited through
+ * Table, i.e., the backing storage of any matrix beyond a few entries is
+ * aligned to 64-byte boundaries, suitable for aligned SIMD loads and the
+ * fast paths of external BLAS implementations.
+ *
  * @note Instantiations for this template are provided for <tt>@<float@>,
  * @<double@>, @<std::complex@<float@>@>,
  * @<std::complex@<double@>@></tt>. Others can be generated in application
@@ -14,10 +14,15 @@
 // ---------------------------------------------------------------------
 
 
+#include <deal.II/base/aligned_vector.h>
+#include <deal.II/base/array_view.h>
+#include <deal.II/base/multithread_info.h>
 #include <deal.II/base/polynomial.h>
 #include <deal.II/base/qprojector.h>
 #include <deal.II/base/quadrature_lib.h>
 #include <deal.II/base/tensor_product_polynomials.h>
+#include <deal.II/base/thread_management.h>
+#include <deal.II/base/vectorization.h>
 
 #include <deal.II/dofs/dof_accessor.h>
 
@@ -27,6 +32,7 @@
 #include <deal.II/fe/fe_tools.h>
 #include <deal.II/fe/mapping.h>
 
+#include <algorithm>
 #include <memory>
 #include <sstream>
 
@@ -68,9 +74,10 @@ namespace
     /**
      * Return the number of polynomials in the space without requiring to
      * build an object of PolynomialsRaviartThomas. This is required by the
-     * FiniteElement classes.
+     * FiniteElement classes. The function is constexpr so that the result
+     * folds into a constant whenever the degree is known at compile time.
      */
-    static unsigned int
+    static constexpr unsigned int
     n_polynomials(const unsigned int degree);
 
     const std::vector<unsigned int> &
@@ -92,12 +99,56 @@ namespace
     std::vector<Point<dim>>
     get_polynomial_support_points() const;
 
+    /**
+     * Tabulate the values of all polynomials at the given set of points.
+     * Subsequent calls to evaluate() that request only values (no
+     * derivatives) at one of these points then reduce to copying the
+     * precomputed row instead of evaluating the polynomial space. This pays
+     * off because the element is evaluated over and over at the same fixed
+     * point sets (support points, quadrature points) while setting up
+     * interpolation and embedding matrices. Only the function values are
+     * tabulated; storing all derivative orders as well would take orders of
+     * magnitude more memory than the polynomial description itself.
+     */
+    void
+    precompute_at_points(const std::vector<Point<dim>> &points);
+
+    /**
+     * Compute the values and first derivatives of all polynomials at a
+     * whole batch of points at once. The per-point tensor components are
+     * far too short to fill the SIMD lanes of current hardware, so this
+     * function instead vectorizes across the points: the 1d factors of the
+     * tensor product are evaluated per point, packed into VectorizedArray
+     * lanes, and the combination into the dim-dimensional values and
+     * gradients -- where almost all of the arithmetic happens -- is then
+     * carried out on full vectors. A remainder of points that does not fill
+     * a complete SIMD vector is processed by the scalar evaluate().
+     *
+     * Each entry of @p values and @p grads corresponds to one point and
+     * must be sized <tt>n()</tt>. An empty @p grads view skips the
+     * gradient computation altogether.
+     */
+    void
+    evaluate_batch(const ArrayView<const Point<dim>> &           unit_points,
+                   const ArrayView<std::vector<Tensor<1, dim>>> &values,
+                   const ArrayView<std::vector<Tensor<2, dim>>> &grads) const;
+
   private:
     /**
      * The degree variable passed to the constructor.
      */
     const unsigned int degree;
 
+    /**
+     * The 1d Lagrange bases underlying the anisotropic polynomial space,
+     * one set per coordinate direction. Entry 0 holds the basis in the
+     * continuous (normal) direction, the other entries the lower-degree
+     * basis of the remaining directions. Kept around for the batched
+     * evaluation path, which works directly on the 1d factors.
+     */
+    const std::vector<std::vector<Polynomials::Polynomial<double>>>
+      polynomials_1d;
+
     /**
      * An object representing the polynomial space for a single component. We
      * can re-use it by rotating the coordinates of the evaluation point.
@@ -119,6 +170,43 @@ namespace
      * Renumbering from shifted polynomial spaces to lexicographic one
      */
     std::array<std::vector<unsigned int>, dim> renumber_aniso;
+
+    /**
+     * For each direction d, the composition of #renumber_aniso and
+     * #lexicographic_to_hierarchic, i.e., the index in the element numbering
+     * that entry j of the shifted polynomial space gets scattered to. Using
+     * this composed table, the scratch buffers filled by the polynomial
+     * space are traversed with unit stride in evaluate(), rather than being
+     * gathered through two levels of indirection.
+     *
+     * The dim tables are stored back-to-back in a single cache-line-aligned
+     * allocation (direction d starts at offset <tt>d * n_sub</tt>), as this
+     * table is read once per polynomial in the innermost loops of
+     * evaluate() and should stay resident in L1.
+     */
+    AlignedVector<unsigned int> aniso_to_hierarchic;
+
+    /**
+     * For each direction d, the cyclic rotation of the tensor components
+     * applied when transferring derivatives from the rotated coordinate
+     * system back to the actual one, i.e.,
+     * <tt>component_shift[d][c] = (c + d) % dim</tt>. Tabulated once in the
+     * constructor to avoid the integer divisions in the inner loops of
+     * evaluate().
+     */
+    std::array<std::array<unsigned int, dim>, dim> component_shift;
+
+    /**
+     * The points passed to precompute_at_points(), or empty if no values
+     * have been tabulated.
+     */
+    std::vector<Point<dim>> precomputed_points;
+
+    /**
+     * Values of all polynomials at #precomputed_points, stored row-major
+     * with one row of n() entries per point.
+     */
+    std::vector<Tensor<1, dim>> precomputed_values;
   };
 
 
@@ -147,12 +235,283 @@ namespace
   }
 
 
+  // Combine tabulated 1d values and derivatives into the anisotropic
+  // tensor-product polynomials of the rotated coordinate system of
+  // direction @p d and scatter the result directly into the output arrays
+  // of the full vector-valued space, without any intermediate buffer. @p v
+  // holds one pointer per axis of the rotated space into a table of 1d
+  // values, where entry [m][k] is the k-th derivative of the m-th basis
+  // function at the respective coordinate; @p n_1d contains the number of
+  // basis functions along each axis. Entry q of the rotated space (counted
+  // lexicographically with the first axis running fastest) is written to
+  // component d of tensor scatter[q], with the derivative directions
+  // permuted through @p shift. Only those output arrays that are non-empty
+  // get filled. The template argument @p n_derivative_orders states how
+  // many of the output arrays can be non-empty at most (1 for values only,
+  // up to 5 for fourth derivatives); the blocks for higher orders are
+  // discarded at compile time, so the instantiation for the common
+  // values-and-gradients case does not carry the dim^3 and dim^4 loops of
+  // the higher derivatives. If @p fixed_degree is non-negative, it states
+  // the polynomial degree as a compile-time constant and the loop bounds
+  // below fold to constants, allowing the compiler to fully unroll the
+  // inner loops; -1 selects the generic variant with runtime bounds.
+  template <int dim, int n_derivative_orders, int fixed_degree>
+  void
+  compute_tensor_product_derivatives(
+    const std::array<const std::array<double, 5> *, 3> &v,
+    const unsigned int (&n_1d)[3],
+    const unsigned int                                  d,
+    const unsigned int *DEAL_II_RESTRICT                scatter,
+    const unsigned int *DEAL_II_RESTRICT                shift,
+    std::vector<Tensor<1, dim>> &values,
+    std::vector<Tensor<2, dim>> &grads,
+    std::vector<Tensor<3, dim>> &grad_grads,
+    std::vector<Tensor<4, dim>> &third_derivatives,
+    std::vector<Tensor<5, dim>> &fourth_derivatives)
+  {
+    const bool update_values          = (values.size() != 0),
+               update_grads           = (grads.size() != 0),
+               update_grad_grads      = (grad_grads.size() != 0),
+               update_3rd_derivatives = (third_derivatives.size() != 0),
+               update_4th_derivatives = (fourth_derivatives.size() != 0);
+    (void)update_grad_grads;
+    (void)update_3rd_derivatives;
+    (void)update_4th_derivatives;
+
+    if constexpr (fixed_degree >= 0)
+      {
+        AssertDimension(n_1d[0], fixed_degree + 2);
+        Assert(dim == 1 || n_1d[1] == fixed_degree + 1,
+               ExcDimensionMismatch(n_1d[1], fixed_degree + 1));
+      }
+    const unsigned int n0 = fixed_degree >= 0 ? fixed_degree + 2 : n_1d[0];
+    const unsigned int n1 =
+      dim > 1 ? (fixed_degree >= 0 ? fixed_degree + 1 : n_1d[1]) : 1;
+    const unsigned int n2 =
+      dim > 2 ? (fixed_degree >= 0 ? fixed_degree + 1 : n_1d[2]) : 1;
+
+    // The fourth-derivative block stores dim^4 entries per polynomial
+    // through the component rotation, an index pattern the vectorizer does
+    // not see through. Flatten it once per call: for every combination of
+    // derivative directions, precompute the linear offset into the
+    // contiguous storage of the rank-4 subtensor and the derivative order
+    // each axis contributes, which turns the four nested loops below into
+    // a single sweep of table-driven multiplies and indexed stores.
+    constexpr unsigned int                       n4 = Utilities::pow(dim, 4);
+    std::array<unsigned int, n4>                 offset_4th{};
+    std::array<std::array<unsigned char, 3>, n4> orders_4th{};
+    if constexpr (n_derivative_orders >= 5)
+      if (update_4th_derivatives)
+        {
+          unsigned int t = 0;
+          for (unsigned int d1 = 0; d1 < dim; ++d1)
+            for (unsigned int d2 = 0; d2 < dim; ++d2)
+              for (unsigned int d3 = 0; d3 < dim; ++d3)
+                for (unsigned int d4 = 0; d4 < dim; ++d4, ++t)
+                  {
+                    offset_4th[t] =
+                      ((shift[d1] * dim + shift[d2]) * dim + shift[d3]) * dim +
+                      shift[d4];
+                    for (const unsigned int dd : {d1, d2, d3, d4})
+                      ++orders_4th[t][dd];
+                  }
+        }
+
+    unsigned int q = 0;
+    for (unsigned int k = 0; k < n2; ++k)
+      for (unsigned int j = 0; j < n1; ++j)
+        {
+          // hoist the partial products over the two outer axes out of the
+          // innermost loop (sum factorization); for values and gradients
+          // this leaves two multiplications per entry, matching the
+          // batched path
+          double v_jk = 1., dy_jk = 0., dz_jk = 0.;
+          if constexpr (dim == 2)
+            {
+              v_jk  = v[1][j][0];
+              dy_jk = v[1][j][1];
+            }
+          else if constexpr (dim == 3)
+            {
+              v_jk  = v[1][j][0] * v[2][k][0];
+              dy_jk = v[1][j][1] * v[2][k][0];
+              dz_jk = v[1][j][0] * v[2][k][1];
+            }
+
+          for (unsigned int i = 0; i < n0; ++i, ++q)
+            {
+              const unsigned int indices[3] = {i, j, k};
+              const unsigned int hier       = scatter[q];
+
+              if (update_values)
+                values[hier][d] = v[0][i][0] * v_jk;
+
+              if constexpr (n_derivative_orders >= 2)
+                if (update_grads)
+                  {
+                    grads[hier][d][shift[0]] = v[0][i][1] * v_jk;
+                    if (dim > 1)
+                      grads[hier][d][shift[1]] = v[0][i][0] * dy_jk;
+                    if (dim > 2)
+                      grads[hier][d][shift[2]] = v[0][i][0] * dz_jk;
+                  }
+
+              if constexpr (n_derivative_orders >= 3)
+                if (update_grad_grads)
+                  for (unsigned int d1 = 0; d1 < dim; ++d1)
+                    for (unsigned int d2 = 0; d2 < dim; ++d2)
+                      {
+                        double der2 = 1.;
+                        for (unsigned int x = 0; x < dim; ++x)
+                          {
+                            unsigned int derivative = 0;
+                            if (d1 == x)
+                              ++derivative;
+                            if (d2 == x)
+                              ++derivative;
+                            der2 *= v[x][indices[x]][derivative];
+                          }
+                        grad_grads[hier][d][shift[d1]][shift[d2]] = der2;
+                      }
+
+              if constexpr (n_derivative_orders >= 4)
+                if (update_3rd_derivatives)
+                  for (unsigned int d1 = 0; d1 < dim; ++d1)
+                    for (unsigned int d2 = 0; d2 < dim; ++d2)
+                      for (unsigned int d3 = 0; d3 < dim; ++d3)
+                        {
+                          double der3 = 1.;
+                          for (unsigned int x = 0; x < dim; ++x)
+                            {
+                              unsigned int derivative = 0;
+                              if (d1 == x)
+                                ++derivative;
+                              if (d2 == x)
+                                ++derivative;
+                              if (d3 == x)
+                                ++derivative;
+                              der3 *= v[x][indices[x]][derivative];
+                            }
+                          third_derivatives[hier][d][shift[d1]][shift[d2]]
+                                           [shift[d3]] = der3;
+                        }
+
+              if constexpr (n_derivative_orders >= 5)
+                if (update_4th_derivatives)
+                  {
+                    double *DEAL_II_RESTRICT out =
+                      fourth_derivatives[hier][d].begin_raw();
+                    for (unsigned int t = 0; t < n4; ++t)
+                      {
+                        double der4 = v[0][i][orders_4th[t][0]];
+                        for (unsigned int x = 1; x < dim; ++x)
+                          der4 *= v[x][indices[x]][orders_4th[t][x]];
+                        out[offset_4th[t]] = der4;
+                      }
+                  }
+            }
+        }
+  }
+
+
+
+  // Translate the runtime number of requested derivative orders into the
+  // corresponding template argument of compute_tensor_product_derivatives().
+  // The degree is forwarded as a template argument as well, so one dispatch
+  // on the degree in the caller covers all derivative orders.
+  template <int dim, int fixed_degree>
+  void
+  dispatch_tensor_product_derivatives(
+    const unsigned int                                  n_values_and_derivatives,
+    const std::array<const std::array<double, 5> *, 3> &v,
+    const unsigned int (&n_1d)[3],
+    const unsigned int                                  d,
+    const unsigned int *DEAL_II_RESTRICT                scatter,
+    const unsigned int *DEAL_II_RESTRICT                shift,
+    std::vector<Tensor<1, dim>> &values,
+    std::vector<Tensor<2, dim>> &grads,
+    std::vector<Tensor<3, dim>> &grad_grads,
+    std::vector<Tensor<4, dim>> &third_derivatives,
+    std::vector<Tensor<5, dim>> &fourth_derivatives)
+  {
+    switch (n_values_and_derivatives)
+      {
+        case 1:
+          compute_tensor_product_derivatives<dim, 1, fixed_degree>(
+            v,
+            n_1d,
+            d,
+            scatter,
+            shift,
+            values,
+            grads,
+            grad_grads,
+            third_derivatives,
+            fourth_derivatives);
+          break;
+        case 2:
+          compute_tensor_product_derivatives<dim, 2, fixed_degree>(
+            v,
+            n_1d,
+            d,
+            scatter,
+            shift,
+            values,
+            grads,
+            grad_grads,
+            third_derivatives,
+            fourth_derivatives);
+          break;
+        case 3:
+          compute_tensor_product_derivatives<dim, 3, fixed_degree>(
+            v,
+            n_1d,
+            d,
+            scatter,
+            shift,
+            values,
+            grads,
+            grad_grads,
+            third_derivatives,
+            fourth_derivatives);
+          break;
+        case 4:
+          compute_tensor_product_derivatives<dim, 4, fixed_degree>(
+            v,
+            n_1d,
+            d,
+            scatter,
+            shift,
+            values,
+            grads,
+            grad_grads,
+            third_derivatives,
+            fourth_derivatives);
+          break;
+        default:
+          compute_tensor_product_derivatives<dim, 5, fixed_degree>(
+            v,
+            n_1d,
+            d,
+            scatter,
+            shift,
+            values,
+            grads,
+            grad_grads,
+            third_derivatives,
+            fourth_derivatives);
+          break;
+      }
+  }
+
+
   template <int dim>
   PolynomialsRaviartThomasNodal<dim>::PolynomialsRaviartThomasNodal(
     const unsigned int degree)
     : TensorPolynomialsBase<dim>(degree, n_polynomials(degree))
     , degree(degree)
-    , polynomial_space(create_rt_polynomials(dim, degree))
+    , polynomials_1d(create_rt_polynomials(dim, degree))
+    , polynomial_space(polynomials_1d)
   {
     // create renumbering of the unknowns from the lexicographic order to the
     // actual order required by the finite element class with unknowns on
@@ -164,38 +523,236 @@ namespace
     hierarchic_to_lexicographic =
       Utilities::invert_permutation(lexicographic_to_hierarchic);
 
+    // tabulate the rotation of tensor components for each direction once,
+    // so that evaluate() does not need to compute any modulus in its inner
+    // loops
+    for (unsigned int d = 0; d < dim; ++d)
+      for (unsigned int c = 0; c < dim; ++c)
+        component_shift[d][c] = (c + d) % dim;
+
     // since we only store an anisotropic polynomial for the first component,
     // we set up a second numbering to switch out the actual coordinate
     // direction
     renumber_aniso[0].resize(n_pols);
     for (unsigned int i = 0; i < n_pols; ++i)
       renumber_aniso[0][i] = i;
+    // the writes below are already unit-stride (the loop order matches the
+    // layout of the tables); only the stored values jump around, so all
+    // that is left to do is to strength-reduce the index arithmetic into
+    // running counters
     if (dim == 2)
       {
         // switch x and y component (i and j loops)
         renumber_aniso[1].resize(n_pols);
+        unsigned int q = 0;
         for (unsigned int j = 0; j < degree + 2; ++j)
-          for (unsigned int i = 0; i < degree + 1; ++i)
-            renumber_aniso[1][j * (degree + 1) + i] = j + i * (degree + 2);
+          for (unsigned int i = 0, v = j; i < degree + 1;
+               ++i, v += degree + 2, ++q)
+            renumber_aniso[1][q] = v;
       }
     if (dim == 3)
       {
+        const unsigned int stride_z = (degree + 2) * (degree + 1);
+
         // switch x, y, and z component (i, j, k) -> (j, k, i)
         renumber_aniso[1].resize(n_pols);
+        unsigned int q = 0;
         for (unsigned int k = 0; k < degree + 1; ++k)
           for (unsigned int j = 0; j < degree + 2; ++j)
-            for (unsigned int i = 0; i < degree + 1; ++i)
-              renumber_aniso[1][(k * (degree + 2) + j) * (degree + 1) + i] =
-                j + k * (degree + 2) + i * (degree + 2) * (degree + 1);
+            for (unsigned int i = 0, v = j + k * (degree + 2); i < degree + 1;
+                 ++i, v += stride_z, ++q)
+              renumber_aniso[1][q] = v;
 
         // switch x, y, and z component (i, j, k) -> (k, i, j)
         renumber_aniso[2].resize(n_pols);
+        q = 0;
         for (unsigned int k = 0; k < degree + 2; ++k)
           for (unsigned int j = 0; j < degree + 1; ++j)
-            for (unsigned int i = 0; i < degree + 1; ++i)
-              renumber_aniso[2][(k * (degree + 1) + j) * (degree + 1) + i] =
-                k + i * (degree + 2) + j * (degree + 2) * (degree + 1);
+            for (unsigned int i = 0, v = k + j * stride_z; i < degree + 1;
+                 ++i, v += degree + 2, ++q)
+              renumber_aniso[2][q] = v;
       }
+
+    // finally, pre-compose the two renumbering steps applied in evaluate()
+    // into a single scatter table per direction
+    aniso_to_hierarchic.resize(dim * n_pols);
+    for (unsigned int d = 0; d < dim; ++d)
+      for (unsigned int i = 0; i < n_pols; ++i)
+        aniso_to_hierarchic[d * n_pols + renumber_aniso[d][i]] =
+          lexicographic_to_hierarchic[i + d * n_pols];
+
+    // tabulate the values at the node points of the element, which are the
+    // points the finite element classes evaluate at repeatedly when setting
+    // up interpolation and embedding matrices
+    precompute_at_points(get_polynomial_support_points());
+  }
+
+
+
+  template <int dim>
+  void
+  PolynomialsRaviartThomasNodal<dim>::precompute_at_points(
+    const std::vector<Point<dim>> &points)
+  {
+    // invalidate a possibly existing table first, so that the evaluate()
+    // calls below actually do their work rather than reading the cache
+    precomputed_points.clear();
+    precomputed_values.resize(points.size() * this->n());
+
+    std::vector<Tensor<1, dim>> row(this->n());
+    std::vector<Tensor<2, dim>> empty2;
+    std::vector<Tensor<3, dim>> empty3;
+    std::vector<Tensor<4, dim>> empty4;
+    std::vector<Tensor<5, dim>> empty5;
+    for (unsigned int p = 0; p < points.size(); ++p)
+      {
+        evaluate(points[p], row, empty2, empty3, empty4, empty5);
+        std::copy(row.begin(),
+                  row.end(),
+                  precomputed_values.begin() + p * this->n());
+      }
+
+    precomputed_points = points;
+  }
+
+
+
+  template <int dim>
+  void
+  PolynomialsRaviartThomasNodal<dim>::evaluate_batch(
+    const ArrayView<const Point<dim>> &           unit_points,
+    const ArrayView<std::vector<Tensor<1, dim>>> &values,
+    const ArrayView<std::vector<Tensor<2, dim>>> &grads) const
+  {
+    AssertDimension(values.size(), unit_points.size());
+    Assert(grads.size() == unit_points.size() || grads.size() == 0,
+           ExcDimensionMismatch(grads.size(), unit_points.size()));
+
+    const bool do_grads = grads.size() > 0;
+
+    constexpr unsigned int n_lanes = VectorizedArray<double>::size();
+
+    // sizes of the 1d bases along the axes of the (rotated) anisotropic
+    // space; a fictitious third axis of size one lets the same code cover
+    // the 2d case
+    const unsigned int n_1d[3] = {degree + 2,
+                                  dim > 1 ? degree + 1 : 1,
+                                  dim > 2 ? degree + 1 : 1};
+    const unsigned int n_1d_max = degree + 2;
+
+    // 1d values and first derivatives of each basis function at the points
+    // of the current batch, one SIMD vector per (axis, basis function)
+    static thread_local AlignedVector<VectorizedArray<double>> one_d_data;
+    one_d_data.resize(2 * 3 * n_1d_max);
+    const auto value_1d = [&](const unsigned int c,
+                              const unsigned int m) -> VectorizedArray<double> & {
+      return one_d_data[(2 * c) * n_1d_max + m];
+    };
+    const auto deriv_1d = [&](const unsigned int c,
+                              const unsigned int m) -> VectorizedArray<double> & {
+      return one_d_data[(2 * c + 1) * n_1d_max + m];
+    };
+
+    unsigned int point = 0;
+    for (; point + n_lanes <= unit_points.size(); point += n_lanes)
+      {
+        for (unsigned int d = 0; d < dim; ++d)
+          {
+            const std::array<unsigned int, dim> &shift = component_shift[d];
+            const unsigned int *DEAL_II_RESTRICT scatter =
+              aniso_to_hierarchic.data() + d * polynomial_space.n();
+
+            // evaluate the 1d factors lane by lane (cheap, O(degree) each)
+            // and pack them into SIMD vectors
+            for (unsigned int c = 0; c < 3; ++c)
+              for (unsigned int m = 0; m < n_1d[c]; ++m)
+                {
+                  VectorizedArray<double> &val = value_1d(c, m);
+                  VectorizedArray<double> &der = deriv_1d(c, m);
+                  if (c < dim)
+                    for (unsigned int l = 0; l < n_lanes; ++l)
+                      {
+                        double v_and_d[2];
+                        polynomials_1d[c][m].value(
+                          unit_points[point + l][shift[c]],
+                          do_grads ? 1 : 0,
+                          v_and_d);
+                        val[l] = v_and_d[0];
+                        der[l] = do_grads ? v_and_d[1] : 0.;
+                      }
+                  else
+                    {
+                      val = 1.;
+                      der = 0.;
+                    }
+                }
+
+            // combine the 1d factors into the anisotropic tensor product;
+            // this triple loop carries the bulk of the arithmetic and runs
+            // entirely on SIMD vectors across the points of the batch
+            unsigned int q = 0;
+            for (unsigned int k = 0; k < n_1d[2]; ++k)
+              for (unsigned int j = 0; j < n_1d[1]; ++j)
+                {
+                  const VectorizedArray<double> v_jk =
+                    value_1d(1, j) * value_1d(2, k);
+                  if (do_grads)
+                    {
+                      const VectorizedArray<double> dy_jk =
+                        deriv_1d(1, j) * value_1d(2, k);
+                      const VectorizedArray<double> dz_jk =
+                        value_1d(1, j) * deriv_1d(2, k);
+
+                      for (unsigned int i = 0; i < n_1d[0]; ++i, ++q)
+                        {
+                          const VectorizedArray<double> val =
+                            value_1d(0, i) * v_jk;
+                          const VectorizedArray<double> grad_0 =
+                            deriv_1d(0, i) * v_jk;
+                          const VectorizedArray<double> grad_1 =
+                            value_1d(0, i) * dy_jk;
+                          const VectorizedArray<double> grad_2 =
+                            value_1d(0, i) * dz_jk;
+
+                          const unsigned int hier = scatter[q];
+                          for (unsigned int l = 0; l < n_lanes; ++l)
+                            {
+                              values[point + l][hier][d]          = val[l];
+                              grads[point + l][hier][d][shift[0]] = grad_0[l];
+                              if (dim > 1)
+                                grads[point + l][hier][d][shift[1]] =
+                                  grad_1[l];
+                              if (dim > 2)
+                                grads[point + l][hier][d][shift[2]] =
+                                  grad_2[l];
+                            }
+                        }
+                    }
+                  else
+                    for (unsigned int i = 0; i < n_1d[0]; ++i, ++q)
+                      {
+                        const VectorizedArray<double> val =
+                          value_1d(0, i) * v_jk;
+                        const unsigned int hier = scatter[q];
+                        for (unsigned int l = 0; l < n_lanes; ++l)
+                          values[point + l][hier][d] = val[l];
+                      }
+                }
+          }
+      }
+
+    // process the remainder of the batch with the scalar code
+    std::vector<Tensor<2, dim>> empty2;
+    std::vector<Tensor<3, dim>> empty3;
+    std::vector<Tensor<4, dim>> empty4;
+    std::vector<Tensor<5, dim>> empty5;
+    for (; point < unit_points.size(); ++point)
+      evaluate(unit_points[point],
+               values[point],
+               do_grads ? grads[point] : empty2,
+               empty3,
+               empty4,
+               empty5);
   }
 
 
@@ -223,74 +780,142 @@ namespace
              fourth_derivatives.size() == 0,
            ExcDimensionMismatch(fourth_derivatives.size(), this->n()));
 
-    std::vector<double>         p_values;
-    std::vector<Tensor<1, dim>> p_grads;
-    std::vector<Tensor<2, dim>> p_grad_grads;
-    std::vector<Tensor<3, dim>> p_third_derivatives;
-    std::vector<Tensor<4, dim>> p_fourth_derivatives;
+    // If only function values are requested and the evaluation point is one
+    // of those tabulated by precompute_at_points(), copy the stored row and
+    // bypass the polynomial evaluation entirely.
+    if (values.size() == this->n() && grads.empty() && grad_grads.empty() &&
+        third_derivatives.empty() && fourth_derivatives.empty())
+      for (unsigned int p = 0; p < precomputed_points.size(); ++p)
+        if (precomputed_points[p] == unit_point)
+          {
+            std::copy(precomputed_values.begin() + p * this->n(),
+                      precomputed_values.begin() + (p + 1) * this->n(),
+                      values.begin());
+            return;
+          }
 
     const unsigned int n_sub = polynomial_space.n();
-    p_values.resize((values.size() == 0) ? 0 : n_sub);
-    p_grads.resize((grads.size() == 0) ? 0 : n_sub);
-    p_grad_grads.resize((grad_grads.size() == 0) ? 0 : n_sub);
-    p_third_derivatives.resize((third_derivatives.size() == 0) ? 0 : n_sub);
-    p_fourth_derivatives.resize((fourth_derivatives.size() == 0) ? 0 : n_sub);
 
-    for (unsigned int d = 0; d < dim; ++d)
+    unsigned int n_values_and_derivatives = 0;
+    if (values.size() != 0)
+      n_values_and_derivatives = 1;
+    if (grads.size() != 0)
+      n_values_and_derivatives = 2;
+    if (grad_grads.size() != 0)
+      n_values_and_derivatives = 3;
+    if (third_derivatives.size() != 0)
+      n_values_and_derivatives = 4;
+    if (fourth_derivatives.size() != 0)
+      n_values_and_derivatives = 5;
+    if (n_values_and_derivatives == 0)
+      return;
+
+    // The polynomial space for component d consists of polynomials of
+    // degree k+1 in x_d and degree k in the other variables, i.e., the same
+    // anisotropic space rotated through all coordinate directions. Instead
+    // of evaluating the space dim times at rotated points -- which would
+    // evaluate each 1d factor dim times at the same coordinate -- tabulate
+    // the values and derivatives of both 1d bases at every coordinate of
+    // the evaluation point once, and form the tensor products per
+    // direction from this shared table.
+    const unsigned int n_big   = polynomials_1d[0].size();
+    const unsigned int n_small = dim > 1 ? polynomials_1d[1].size() : 0;
+
+    // Scratch for the shared 1d table. Deliberately an ordinary local
+    // rather than a per-thread buffer: the direction tasks below read it
+    // while the caller waits in join_all(), and the task scheduler lets a
+    // waiting thread pick up unrelated queued work. A stolen task that
+    // re-enters evaluate() on that thread would resize and refill any
+    // thread-local scratch while the first call's tasks are still reading
+    // it. The allocation is only dim * (n_big + n_small) small arrays and
+    // is dwarfed by the tensor-product work below.
+    std::vector<std::array<double, 5>> v_1d(dim * (n_big + n_small));
+    for (unsigned int a = 0; a < dim; ++a)
       {
-        // First we copy the point. The polynomial space for component d
-        // consists of polynomials of degree k in x_d and degree k+1 in the
-        // other variables. in order to simplify this, we use the same
-        // AnisotropicPolynomial space and simply rotate the coordinates
-        // through all directions.
-        Point<dim> p;
-        for (unsigned int c = 0; c < dim; ++c)
-          p(c) = unit_point((c + d) % dim);
-
-        polynomial_space.evaluate(p,
-                                  p_values,
-                                  p_grads,
-                                  p_grad_grads,
-                                  p_third_derivatives,
-                                  p_fourth_derivatives);
-
-        for (unsigned int i = 0; i < p_values.size(); ++i)
-          values[lexicographic_to_hierarchic[i + d * n_sub]][d] =
-            p_values[renumber_aniso[d][i]];
-
-        for (unsigned int i = 0; i < p_grads.size(); ++i)
-          for (unsigned int d1 = 0; d1 < dim; ++d1)
-            grads[lexicographic_to_hierarchic[i + d * n_sub]][d]
-                 [(d1 + d) % dim] = p_grads[renumber_aniso[d][i]][d1];
+        const double          x   = unit_point[a];
+        std::array<double, 5> *row = v_1d.data() + a * (n_big + n_small);
+        for (unsigned int m = 0; m < n_big; ++m)
+          polynomials_1d[0][m].value(x,
+                                     n_values_and_derivatives - 1,
+                                     row[m].data());
+        if (dim > 1)
+          for (unsigned int m = 0; m < n_small; ++m)
+            polynomials_1d[1][m].value(x,
+                                       n_values_and_derivatives - 1,
+                                       row[n_big + m].data());
+      }
 
-        for (unsigned int i = 0; i < p_grad_grads.size(); ++i)
-          for (unsigned int d1 = 0; d1 < dim; ++d1)
-            for (unsigned int d2 = 0; d2 < dim; ++d2)
-              grad_grads[lexicographic_to_hierarchic[i + d * n_sub]][d]
-                        [(d1 + d) % dim][(d2 + d) % dim] =
-                          p_grad_grads[renumber_aniso[d][i]][d1][d2];
+    const unsigned int n_1d[3] = {n_big, n_small, n_small};
 
-        for (unsigned int i = 0; i < p_third_derivatives.size(); ++i)
-          for (unsigned int d1 = 0; d1 < dim; ++d1)
-            for (unsigned int d2 = 0; d2 < dim; ++d2)
-              for (unsigned int d3 = 0; d3 < dim; ++d3)
-                third_derivatives[lexicographic_to_hierarchic[i + d * n_sub]][d]
-                                 [(d1 + d) % dim][(d2 + d) % dim]
-                                 [(d3 + d) % dim] =
-                                   p_third_derivatives[renumber_aniso[d][i]][d1]
-                                                      [d2][d3];
+    const auto evaluate_direction = [&](const unsigned int d) {
+      // axis c of the rotated coordinate system uses coordinate
+      // (c + d) % dim of the evaluation point; axis 0 carries the
+      // higher-degree basis, the other axes the lower-degree one
+      std::array<const std::array<double, 5> *, 3> v_axes = {
+        {nullptr, nullptr, nullptr}};
+      for (unsigned int c = 0; c < dim; ++c)
+        {
+          const std::array<double, 5> *row =
+            v_1d.data() + component_shift[d][c] * (n_big + n_small);
+          v_axes[c] = (c == 0) ? row : row + n_big;
+        }
 
-        for (unsigned int i = 0; i < p_fourth_derivatives.size(); ++i)
-          for (unsigned int d1 = 0; d1 < dim; ++d1)
-            for (unsigned int d2 = 0; d2 < dim; ++d2)
-              for (unsigned int d3 = 0; d3 < dim; ++d3)
-                for (unsigned int d4 = 0; d4 < dim; ++d4)
-                  fourth_derivatives[lexicographic_to_hierarchic[i + d * n_sub]]
-                                    [d][(d1 + d) % dim][(d2 + d) % dim]
-                                    [(d3 + d) % dim][(d4 + d) % dim] =
-                                      p_fourth_derivatives[renumber_aniso[d][i]]
-                                                          [d1][d2][d3][d4];
+      // forward the requested derivative orders -- and, for the degrees
+      // production runs actually use, the degree itself -- into template
+      // arguments, so the combination loops run with compile-time bounds
+      // whenever possible
+      const auto dispatch = [&](auto fixed_degree) {
+        dispatch_tensor_product_derivatives<dim,
+                                            decltype(fixed_degree)::value>(
+          n_values_and_derivatives,
+          v_axes,
+          n_1d,
+          d,
+          aniso_to_hierarchic.data() + d * n_sub,
+          component_shift[d].data(),
+          values,
+          grads,
+          grad_grads,
+          third_derivatives,
+          fourth_derivatives);
+      };
+      switch (degree)
+        {
+          case 0:
+            dispatch(std::integral_constant<int, 0>());
+            break;
+          case 1:
+            dispatch(std::integral_constant<int, 1>());
+            break;
+          case 2:
+            dispatch(std::integral_constant<int, 2>());
+            break;
+          case 3:
+            dispatch(std::integral_constant<int, 3>());
+            break;
+          default:
+            dispatch(std::integral_constant<int, -1>());
+            break;
+        }
+    };
+
+    // The dim directions write disjoint slabs of the output arrays and
+    // share only read-only data, so they can run concurrently. Spawning
+    // tasks only pays off when the component spaces are large enough to
+    // amortize the scheduling overhead, which for the common low degrees
+    // they are not.
+    if (dim > 1 && n_sub > 100 && MultithreadInfo::n_threads() > 1)
+      {
+        Threads::TaskGroup<> tasks;
+        for (unsigned int d = 0; d < dim; ++d)
+          tasks += Threads::new_task([&evaluate_direction, d]() {
+            evaluate_direction(d);
+          });
+        tasks.join_all();
       }
+    else
+      for (unsigned int d = 0; d < dim; ++d)
+        evaluate_direction(d);
   }
 
 
@@ -305,8 +930,8 @@ namespace
 
 
   template <int dim>
-  unsigned int
-  PolynomialsRaviartThomasNodal<dim>::n_polynomials(unsigned int degree)
+  constexpr unsigned int
+  PolynomialsRaviartThomasNodal<dim>::n_polynomials(const unsigned int degree)
   {
     return dim * (degree + 2) * Utilities::pow(degree + 1, dim - 1);
   }
@@ -430,7 +1055,9 @@ namespace internal
 // --------------------- actual implementation of element --------------------
 
 template <int dim>
-FE_RaviartThomasNodal<dim>::FE_RaviartThomasNodal(const unsigned int degree)
+FE_RaviartThomasNodal<dim>::FE_RaviartThomasNodal(
+  const unsigned int degree,
+  const bool         precompute_transfer_matrices)
   : FE_PolyTensor<dim>(PolynomialsRaviartThomasNodal<dim>(degree),
                        FiniteElementData<dim>(get_rt_dpo_vector(dim, degree),
                                               dim,
@@ -470,18 +1097,68 @@ FE_RaviartThomasNodal<dim>::FE_RaviartThomasNodal(const unsigned int degree)
   this->interface_constraints.reinit(GeometryInfo<dim>::max_children_per_face *
                                        this->n_dofs_per_face(face_no),
                                      this->n_dofs_per_face(face_no));
-  unsigned int target_row = 0;
+  // copy each face embedding matrix en bloc into its row range of the
+  // constraint matrix; both matrices are stored row-major, so this is a
+  // contiguous copy rather than an element-wise loop
   for (unsigned int d = 0; d < GeometryInfo<dim>::max_children_per_face; ++d)
-    for (unsigned int i = 0; i < face_embeddings[d].m(); ++i)
-      {
-        for (unsigned int j = 0; j < face_embeddings[d].n(); ++j)
-          this->interface_constraints(target_row, j) = face_embeddings[d](i, j);
-        ++target_row;
-      }
+    this->interface_constraints.fill(face_embeddings[d],
+                                     d * this->n_dofs_per_face(face_no),
+                                     0,
+                                     0,
+                                     0);
 
   // We need to initialize the dof permutation table and the one for the sign
   // change.
   initialize_quad_dof_index_permutation_and_sign_change();
+
+  // Tabulate which vector component each dof evaluates at its generalized
+  // support point: the normal direction of the owning face for the face
+  // dofs, then the component of the owning chunk for the interior dofs.
+  dof_evaluation_component.resize(this->n_dofs_per_cell());
+  unsigned int k = 0;
+  for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
+    for (unsigned int i = 0; i < this->n_dofs_per_face(f); ++i, ++k)
+      dof_evaluation_component[k] = GeometryInfo<dim>::unit_normal_direction[f];
+  Assert((this->n_dofs_per_cell() - k) % dim == 0, ExcInternalError());
+  const unsigned int istep = (this->n_dofs_per_cell() - k) / dim;
+  for (unsigned int d = 0; d < dim; ++d)
+    for (unsigned int i = 0; i < istep; ++i, ++k)
+      dof_evaluation_component[k] = d;
+  AssertDimension(k, this->n_dofs_per_cell());
+
+  // Tabulate the face support pattern queried by has_support_on_face(): a
+  // shape function associated with a face vanishes on the opposite face;
+  // for all other pairings we have to conservatively report support.
+  static_assert(GeometryInfo<dim>::faces_per_cell <= 8,
+                "face bits must fit into one byte");
+  support_on_face_mask.resize(this->n_dofs_per_cell(),
+                              static_cast<std::uint8_t>(
+                                (1u << GeometryInfo<dim>::faces_per_cell) - 1));
+  k = 0;
+  for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
+    for (unsigned int i = 0; i < this->n_dofs_per_face(f); ++i, ++k)
+      support_on_face_mask[k] &=
+        static_cast<std::uint8_t>(~(1u << GeometryInfo<dim>::opposite_face[f]));
+
+  // Rule of thumb for the FP accuracy that can be expected for the given
+  // polynomial degree; used to snap interpolation matrix entries close to
+  // zero or one. Degree and dimension are fixed per instance, so compute it
+  // once here rather than per call.
+  interp_snap_eps = 2e-13 * this->degree * (dim - 1);
+
+  // On request, move the cost of the lazily computed transfer matrices for
+  // isotropic refinement -- by far the most common refinement mode -- into
+  // element setup, so that the first refinement or multigrid step does not
+  // stall all threads behind the initialization mutex.
+  if (precompute_transfer_matrices)
+    for (unsigned int c = 0;
+         c < GeometryInfo<dim>::n_children(
+               RefinementCase<dim>::isotropic_refinement);
+         ++c)
+      {
+        get_prolongation_matrix(c, RefinementCase<dim>::isotropic_refinement);
+        get_restriction_matrix(c, RefinementCase<dim>::isotropic_refinement);
+      }
 }
 
 
@@ -527,49 +1204,49 @@ FE_RaviartThomasNodal<
   const unsigned int n       = this->degree;
   const unsigned int face_no = 0;
   Assert(n * n == this->n_dofs_per_quad(face_no), ExcInternalError());
-  for (unsigned int local = 0; local < this->n_dofs_per_quad(face_no); ++local)
-    // face support points are in lexicographic ordering with x running
-    // fastest. invert that (y running fastest)
-    {
-      unsigned int i = local % n, j = local / n;
-
-      // face_orientation=false, face_flip=false, face_rotation=false
-      this->adjust_quad_dof_index_for_face_orientation_table[face_no](local,
-                                                                      0) =
-        j + i * n - local;
-      // face_orientation=false, face_flip=false, face_rotation=true
-      this->adjust_quad_dof_index_for_face_orientation_table[face_no](local,
-                                                                      1) =
-        i + (n - 1 - j) * n - local;
-      // face_orientation=false, face_flip=true,  face_rotation=false
-      this->adjust_quad_dof_index_for_face_orientation_table[face_no](local,
-                                                                      2) =
-        (n - 1 - j) + (n - 1 - i) * n - local;
-      // face_orientation=false, face_flip=true,  face_rotation=true
-      this->adjust_quad_dof_index_for_face_orientation_table[face_no](local,
-                                                                      3) =
-        (n - 1 - i) + j * n - local;
-      // face_orientation=true,  face_flip=false, face_rotation=false
-      this->adjust_quad_dof_index_for_face_orientation_table[face_no](local,
-                                                                      4) = 0;
-      // face_orientation=true,  face_flip=false, face_rotation=true
-      this->adjust_quad_dof_index_for_face_orientation_table[face_no](local,
-                                                                      5) =
-        j + (n - 1 - i) * n - local;
-      // face_orientation=true,  face_flip=true,  face_rotation=false
-      this->adjust_quad_dof_index_for_face_orientation_table[face_no](local,
-                                                                      6) =
-        (n - 1 - i) + (n - 1 - j) * n - local;
-      // face_orientation=true,  face_flip=true,  face_rotation=true
-      this->adjust_quad_dof_index_for_face_orientation_table[face_no](local,
-                                                                      7) =
-        (n - 1 - j) + i * n - local;
-
-      // for face_orientation == false, we need to switch the sign
-      for (unsigned int i = 0; i < 4; ++i)
-        this->adjust_quad_dof_sign_for_face_orientation_table[face_no](local,
-                                                                       i) = 1;
-    }
+
+  Table<2, int> &index_table =
+    this->adjust_quad_dof_index_for_face_orientation_table[face_no];
+  Table<2, bool> &sign_table =
+    this->adjust_quad_dof_sign_for_face_orientation_table[face_no];
+
+  // face support points are in lexicographic ordering with x running
+  // fastest. invert that (y running fastest). instead of decomposing each
+  // local index into (i,j) with a division and a modulus, run the (j,i)
+  // double loop directly and precompute the handful of products the eight
+  // orientation cases are built from, so the loop body is pure addition
+  // and subtraction
+  for (unsigned int j = 0, local = 0; j < n; ++j)
+    for (unsigned int i = 0; i < n; ++i, ++local)
+      {
+        const int ni  = n - 1 - i;
+        const int nj  = n - 1 - j;
+        const int in  = i * n;
+        const int jn  = j * n;
+        const int nin = ni * n;
+        const int njn = nj * n;
+
+        // face_orientation=false, face_flip=false, face_rotation=false
+        index_table(local, 0) = j + in - local;
+        // face_orientation=false, face_flip=false, face_rotation=true
+        index_table(local, 1) = i + njn - local;
+        // face_orientation=false, face_flip=true,  face_rotation=false
+        index_table(local, 2) = nj + nin - local;
+        // face_orientation=false, face_flip=true,  face_rotation=true
+        index_table(local, 3) = ni + jn - local;
+        // face_orientation=true,  face_flip=false, face_rotation=false
+        index_table(local, 4) = 0;
+        // face_orientation=true,  face_flip=false, face_rotation=true
+        index_table(local, 5) = j + nin - local;
+        // face_orientation=true,  face_flip=true,  face_rotation=false
+        index_table(local, 6) = ni + njn - local;
+        // face_orientation=true,  face_flip=true,  face_rotation=true
+        index_table(local, 7) = nj + in - local;
+
+        // for face_orientation == false, we need to switch the sign
+        for (unsigned int c = 0; c < 4; ++c)
+          sign_table(local, c) = 1;
+      }
 }
 
 
@@ -583,17 +1260,11 @@ FE_RaviartThomasNodal<dim>::has_support_on_face(
   AssertIndexRange(shape_index, this->n_dofs_per_cell());
   AssertIndexRange(face_index, GeometryInfo<dim>::faces_per_cell);
 
-  // The first degrees of freedom are on the faces and each face has degree
-  // degrees.
-  const unsigned int support_face = shape_index / this->n_dofs_per_face();
-
-  // The only thing we know for sure is that shape functions with support on
-  // one face are zero on the opposite face.
-  if (support_face < GeometryInfo<dim>::faces_per_cell)
-    return (face_index != GeometryInfo<dim>::opposite_face[support_face]);
-
-  // In all other cases, return true, which is safe
-  return true;
+  // The pattern only depends on the element and has been tabulated as a bit
+  // matrix in the constructor. This function is called for every (shape
+  // function, face) pair during assembly of face terms, so it should not
+  // perform any division or branching.
+  return (support_on_face_mask[shape_index] >> face_index) & 1u;
 }
 
 
@@ -614,35 +1285,13 @@ FE_RaviartThomasNodal<dim>::
          ExcDimensionMismatch(support_point_values[0].size(),
                               this->n_components()));
 
-  // First do interpolation on faces. There, the component evaluated depends
-  // on the face direction and orientation.
-  unsigned int fbase = 0;
-  unsigned int f     = 0;
-  for (; f < GeometryInfo<dim>::faces_per_cell;
-       ++f, fbase += this->n_dofs_per_face(f))
-    {
-      for (unsigned int i = 0; i < this->n_dofs_per_face(f); ++i)
-        {
-          nodal_values[fbase + i] = support_point_values[fbase + i](
-            GeometryInfo<dim>::unit_normal_direction[f]);
-        }
-    }
-
-  // The remaining points form dim chunks, one for each component
-  const unsigned int istep = (this->n_dofs_per_cell() - fbase) / dim;
-  Assert((this->n_dofs_per_cell() - fbase) % dim == 0, ExcInternalError());
-
-  f = 0;
-  while (fbase < this->n_dofs_per_cell())
-    {
-      for (unsigned int i = 0; i < istep; ++i)
-        {
-          nodal_values[fbase + i] = support_point_values[fbase + i](f);
-        }
-      fbase += istep;
-      ++f;
-    }
-  Assert(fbase == this->n_dofs_per_cell(), ExcInternalError());
+  // Each dof evaluates exactly one vector component at its support point --
+  // the normal component for face dofs, the component of the owning chunk
+  // for interior dofs. Which one it is has been tabulated in the
+  // constructor, so the per-face dispatch collapses into one gather loop
+  // over all dofs.
+  for (unsigned int k = 0; k < this->n_dofs_per_cell(); ++k)
+    nodal_values[k] = support_point_values[k](dof_evaluation_component[k]);
 }
 
 
@@ -687,15 +1336,17 @@ std::vector<std::pair<unsigned int, unsigned int>>
 FE_RaviartThomasNodal<dim>::hp_line_dof_identities(
   const FiniteElement<dim> &fe_other) const
 {
+  // dofs are located on faces; these are only lines in 2d, so whatever the
+  // other element is, there is nothing to report in the other dimensions --
+  // check this before paying for the dynamic_cast below
+  if (dim != 2)
+    return std::vector<std::pair<unsigned int, unsigned int>>();
+
   // we can presently only compute these identities if both FEs are
   // FE_RaviartThomasNodals or if the other one is FE_Nothing
   if (const FE_RaviartThomasNodal<dim> *fe_q_other =
         dynamic_cast<const FE_RaviartThomasNodal<dim> *>(&fe_other))
     {
-      // dofs are located on faces; these are only lines in 2d
-      if (dim != 2)
-        return std::vector<std::pair<unsigned int, unsigned int>>();
-
       // dofs are located along lines, so two dofs are identical only if in
       // the following two cases (remember that the face support points are
       // Gauss points):
@@ -715,9 +1366,11 @@ FE_RaviartThomasNodal<dim>::hp_line_dof_identities(
       std::vector<std::pair<unsigned int, unsigned int>> identities;
 
       if (p == q)
-        for (unsigned int i = 0; i < p + 1; ++i)
-          identities.emplace_back(i, i);
-
+        {
+          identities.reserve(p + 1);
+          for (unsigned int i = 0; i < p + 1; ++i)
+            identities.emplace_back(i, i);
+        }
       else if (p % 2 == 0 && q % 2 == 0)
         identities.emplace_back(p / 2, q / 2);
 
@@ -743,15 +1396,17 @@ FE_RaviartThomasNodal<dim>::hp_quad_dof_identities(
   const FiniteElement<dim> &fe_other,
   const unsigned int        face_no) const
 {
+  // dofs are located on faces; these are only quads in 3d, so there is
+  // nothing to report in the other dimensions regardless of the other
+  // element -- check this before paying for the dynamic_cast below
+  if (dim != 3)
+    return std::vector<std::pair<unsigned int, unsigned int>>();
+
   // we can presently only compute these identities if both FEs are
   // FE_RaviartThomasNodals or if the other one is FE_Nothing
   if (const FE_RaviartThomasNodal<dim> *fe_q_other =
         dynamic_cast<const FE_RaviartThomasNodal<dim> *>(&fe_other))
     {
-      // dofs are located on faces; these are only quads in 3d
-      if (dim != 3)
-        return std::vector<std::pair<unsigned int, unsigned int>>();
-
       // this works exactly like the line case above
       const unsigned int p = this->n_dofs_per_quad(face_no);
 
@@ -761,9 +1416,11 @@ FE_RaviartThomasNodal<dim>::hp_quad_dof_identities(
       std::vector<std::pair<unsigned int, unsigned int>> identities;
 
       if (p == q)
-        for (unsigned int i = 0; i < p; ++i)
-          identities.emplace_back(i, i);
-
+        {
+          identities.reserve(p);
+          for (unsigned int i = 0; i < p; ++i)
+            identities.emplace_back(i, i);
+        }
       else if (p % 2 != 0 && q % 2 != 0)
         identities.emplace_back(p / 2, q / 2);
 
@@ -848,17 +1505,19 @@ FE_RaviartThomasNodal<1>::get_subface_interpolation_matrix(
 
 template <int dim>
 void
-FE_RaviartThomasNodal<dim>::get_face_interpolation_matrix(
+FE_RaviartThomasNodal<dim>::fill_face_interpolation_matrix(
   const FiniteElement<dim> &x_source_fe,
+  const unsigned int        subface,
   FullMatrix<double> &      interpolation_matrix,
   const unsigned int        face_no) const
 {
-  // this is only implemented, if the
-  // source FE is also a
-  // RaviartThomasNodal element
-  AssertThrow((x_source_fe.get_name().find("FE_RaviartThomasNodal<") == 0) ||
-                (dynamic_cast<const FE_RaviartThomasNodal<dim> *>(
-                   &x_source_fe) != nullptr),
+  // this is only implemented, if the source FE is also a RaviartThomasNodal
+  // element. run the RTTI query once and bind the reference below from the
+  // resulting pointer, rather than checking a name string (which allocates)
+  // and then casting a second time
+  const FE_RaviartThomasNodal<dim> *const source_fe_ptr =
+    dynamic_cast<const FE_RaviartThomasNodal<dim> *>(&x_source_fe);
+  AssertThrow(source_fe_ptr != nullptr,
               typename FiniteElement<dim>::ExcInterpolationNotImplemented());
 
   Assert(interpolation_matrix.n() == this->n_dofs_per_face(face_no),
@@ -870,160 +1529,203 @@ FE_RaviartThomasNodal<dim>::get_face_interpolation_matrix(
 
   // ok, source is a RaviartThomasNodal element, so we will be able to do the
   // work
-  const FE_RaviartThomasNodal<dim> &source_fe =
-    dynamic_cast<const FE_RaviartThomasNodal<dim> &>(x_source_fe);
+  const FE_RaviartThomasNodal<dim> &source_fe = *source_fe_ptr;
+
+  // hoist the virtual dof-count queries out of all loop bounds below
+  const unsigned int n_this   = this->n_dofs_per_face(face_no);
+  const unsigned int n_source = source_fe.n_dofs_per_face(face_no);
 
   // Make sure that the element for which the DoFs should be constrained is
   // the one with the higher polynomial degree.  Actually the procedure will
   // work also if this assertion is not satisfied. But the matrices produced
   // in that case might lead to problems in the hp-procedures, which use this
   // method.
-  Assert(this->n_dofs_per_face(face_no) <= source_fe.n_dofs_per_face(face_no),
+  Assert(n_this <= n_source,
          typename FiniteElement<dim>::ExcInterpolationNotImplemented());
 
+  // If both elements have the same degree, the source support points
+  // coincide with the face support points of this element and the nodal
+  // interpolation matrix is the identity -- the common situation of equal
+  // elements meeting at an interface, which does not warrant evaluating
+  // any polynomials. This shortcut does not carry over to the subface
+  // matrices, where the projected points differ from the support points.
+  if (subface == numbers::invalid_unsigned_int &&
+      this->degree == source_fe.degree)
+    {
+      interpolation_matrix = 0.;
+      for (unsigned int i = 0; i < n_this; ++i)
+        interpolation_matrix(i, i) = 1.;
+      return;
+    }
+
+  // the matrix only depends on the source degree, the face, and the
+  // subface, and the hp machinery requests the same few combinations many
+  // times over, so look it up in the cache first
+  const std::array<unsigned int, 3> cache_key{
+    {source_fe.degree, face_no, subface}};
+  {
+    std::lock_guard<std::mutex> lock(face_interpolation_mutex);
+    const auto cached = face_interpolation_cache.find(cache_key);
+    if (cached != face_interpolation_cache.end())
+      {
+        interpolation_matrix = cached->second;
+        return;
+      }
+  }
+
   // generate a quadrature with the generalized support points.  This is later
   // based as a basis for the QProjector, which returns the support points on
-  // the face.
+  // the face. Note that this point only gets reached on a miss of the
+  // interpolation-matrix cache above, so the projection runs once per
+  // (source degree, face, subface) combination rather than once per call.
   Quadrature<dim - 1> quad_face_support(
     source_fe.generalized_face_support_points[face_no]);
 
-  // Rule of thumb for FP accuracy, that can be expected for a given
-  // polynomial degree.  This value is used to cut off values close to zero.
-  double eps = 2e-13 * this->degree * (dim - 1);
+  // Tolerance used to cut off values close to zero or one; computed once in
+  // the constructor since it only depends on the degree and the dimension.
+  const double eps = interp_snap_eps;
 
   // compute the interpolation matrix by simply taking the value at the
-  // support points.
+  // support points
   const Quadrature<dim> face_projection =
-    QProjector<dim>::project_to_face(this->reference_cell(),
-                                     quad_face_support,
-                                     0);
-
-  for (unsigned int i = 0; i < source_fe.n_dofs_per_face(face_no); ++i)
+    (subface == numbers::invalid_unsigned_int) ?
+      QProjector<dim>::project_to_face(this->reference_cell(),
+                                       quad_face_support,
+                                       0) :
+      QProjector<dim>::project_to_subface(this->reference_cell(),
+                                          quad_face_support,
+                                          0,
+                                          subface);
+
+  // evaluate the complete polynomial space at all support points in one
+  // batch instead of calling shape_value_component() for every pair of
+  // point and dof; the batched evaluator vectorizes across the points,
+  // where the per-point tensor components alone would leave the SIMD
+  // lanes unfilled. The polynomial space of this element is always the
+  // file-local PolynomialsRaviartThomasNodal installed by the constructor.
+  const auto *rt_space =
+    dynamic_cast<const PolynomialsRaviartThomasNodal<dim> *>(
+      this->poly_space.get());
+  Assert(rt_space != nullptr, ExcInternalError());
+
+  std::vector<std::vector<Tensor<1, dim>>> shape_values(
+    n_source, std::vector<Tensor<1, dim>>(this->poly_space->n()));
+  rt_space->evaluate_batch(make_array_view(face_projection.get_points()),
+                           make_array_view(shape_values),
+                           ArrayView<std::vector<Tensor<2, dim>>>());
+
+  constexpr unsigned int n_lanes = VectorizedArray<double>::size();
+  AlignedVector<double>  row_values(n_this);
+
+  // the face-to-cell index map only depends on the column; tabulate it once
+  // instead of calling the virtual function for every matrix entry
+  std::vector<unsigned int> face_to_cell(n_this);
+  for (unsigned int j = 0; j < n_this; ++j)
+    face_to_cell[j] = this->face_to_cell_index(j, 0);
+
+  for (unsigned int i = 0; i < n_source; ++i)
     {
-      const Point<dim> &p = face_projection.point(i);
+      const std::vector<Tensor<1, dim>> &point_values = shape_values[i];
 
-      for (unsigned int j = 0; j < this->n_dofs_per_face(face_no); ++j)
+      // gather the requested component of each face dof into a contiguous
+      // buffer ...
+      for (unsigned int j = 0; j < n_this; ++j)
         {
-          double matrix_entry =
-            this->shape_value_component(this->face_to_cell_index(j, 0), p, 0);
-
-          // Correct the interpolated value. I.e. if it is close to 1 or 0,
-          // make it exactly 1 or 0. Unfortunately, this is required to avoid
-          // problems with higher order elements.
-          if (std::fabs(matrix_entry - 1.0) < eps)
-            matrix_entry = 1.0;
-          if (std::fabs(matrix_entry) < eps)
-            matrix_entry = 0.0;
-
-          interpolation_matrix(i, j) = matrix_entry;
+          const unsigned int jc = face_to_cell[j];
+
+          if (this->inverse_node_matrix.n_cols() == 0)
+            row_values[j] = point_values[jc][0];
+          else
+            {
+              double entry = 0.;
+              for (unsigned int k = 0; k < this->inverse_node_matrix.n_cols();
+                   ++k)
+                entry += this->inverse_node_matrix(k, jc) * point_values[k][0];
+              row_values[j] = entry;
+            }
+        }
+
+      // ... then snap the values close to 1 or 0 to exactly 1 or 0 --
+      // unfortunately required to avoid problems with higher order
+      // elements -- and store the row. The matrix row is contiguous, so
+      // this runs on full SIMD vectors with a scalar tail.
+      const VectorizedArray<double> eps_v = eps;
+      unsigned int                  j     = 0;
+      for (; j + n_lanes <= n_this; j += n_lanes)
+        {
+          VectorizedArray<double> entry;
+          entry.load(row_values.data() + j);
+          entry = compare_and_apply_mask<SIMDComparison::less_than>(
+            std::abs(entry), eps_v, VectorizedArray<double>(0.), entry);
+          entry = compare_and_apply_mask<SIMDComparison::less_than>(
+            std::abs(entry - 1.), eps_v, VectorizedArray<double>(1.), entry);
+          entry.store(&interpolation_matrix(i, j));
+        }
+      for (; j < n_this; ++j)
+        {
+          double entry = row_values[j];
+          // single magnitude test against both snap targets: when the entry
+          // lies within eps of 0 or 1, std::round yields exactly that value
+          if (std::min(std::fabs(entry), std::fabs(entry - 1.0)) < eps)
+            entry = std::round(entry);
+          interpolation_matrix(i, j) = entry;
         }
     }
 
 #ifdef DEBUG
   // make sure that the row sum of each of the matrices is 1 at this
-  // point. this must be so since the shape functions sum up to 1
-  for (unsigned int j = 0; j < source_fe.n_dofs_per_face(face_no); ++j)
+  // point. this must be so since the shape functions sum up to 1. the
+  // indices are named as in the fill loop above -- i runs over the rows
+  // (source dofs), j over the columns -- so each row is read contiguously
+  // in the row-major storage of FullMatrix. note that cache hits return
+  // early above, so this O(n^2) verification only runs on the path that
+  // actually produced new numbers
+  for (unsigned int i = 0; i < n_source; ++i)
     {
       double sum = 0.;
 
-      for (unsigned int i = 0; i < this->n_dofs_per_face(face_no); ++i)
-        sum += interpolation_matrix(j, i);
+      for (unsigned int j = 0; j < n_this; ++j)
+        sum += interpolation_matrix(i, j);
 
-      Assert(std::fabs(sum - 1) < 2e-13 * this->degree * (dim - 1),
-             ExcInternalError());
+      Assert(std::fabs(sum - 1) < interp_snap_eps, ExcInternalError());
     }
 #endif
+
+  // store the result for the next request with the same signature
+  {
+    std::lock_guard<std::mutex> lock(face_interpolation_mutex);
+    face_interpolation_cache[cache_key] = interpolation_matrix;
+  }
 }
 
 
+
 template <int dim>
 void
-FE_RaviartThomasNodal<dim>::get_subface_interpolation_matrix(
+FE_RaviartThomasNodal<dim>::get_face_interpolation_matrix(
   const FiniteElement<dim> &x_source_fe,
-  const unsigned int        subface,
   FullMatrix<double> &      interpolation_matrix,
   const unsigned int        face_no) const
 {
-  // this is only implemented, if the source FE is also a RaviartThomasNodal
-  // element
-  AssertThrow((x_source_fe.get_name().find("FE_RaviartThomasNodal<") == 0) ||
-                (dynamic_cast<const FE_RaviartThomasNodal<dim> *>(
-                   &x_source_fe) != nullptr),
-              typename FiniteElement<dim>::ExcInterpolationNotImplemented());
-
-  Assert(interpolation_matrix.n() == this->n_dofs_per_face(face_no),
-         ExcDimensionMismatch(interpolation_matrix.n(),
-                              this->n_dofs_per_face(face_no)));
-  Assert(interpolation_matrix.m() == x_source_fe.n_dofs_per_face(face_no),
-         ExcDimensionMismatch(interpolation_matrix.m(),
-                              x_source_fe.n_dofs_per_face(face_no)));
-
-  // ok, source is a RaviartThomasNodal element, so we will be able to do the
-  // work
-  const FE_RaviartThomasNodal<dim> &source_fe =
-    dynamic_cast<const FE_RaviartThomasNodal<dim> &>(x_source_fe);
-
-  // Make sure that the element for which the DoFs should be constrained is
-  // the one with the higher polynomial degree. Actually the procedure will
-  // work also if this assertion is not satisfied. But the matrices produced
-  // in that case might lead to problems in the hp-procedures, which use this
-  // method.
-  Assert(this->n_dofs_per_face(face_no) <= source_fe.n_dofs_per_face(face_no),
-         typename FiniteElement<dim>::ExcInterpolationNotImplemented());
-
-  // generate a quadrature with the generalized support points.  This is later
-  // based as a basis for the QProjector, which returns the support points on
-  // the face.
-  Quadrature<dim - 1> quad_face_support(
-    source_fe.generalized_face_support_points[face_no]);
-
-  // Rule of thumb for FP accuracy, that can be expected for a given
-  // polynomial degree. This value is used to cut off values close to zero.
-  double eps = 2e-13 * this->degree * (dim - 1);
-
-  // compute the interpolation matrix by simply taking the value at the
-  // support points.
-  const Quadrature<dim> subface_projection =
-    QProjector<dim>::project_to_subface(this->reference_cell(),
-                                        quad_face_support,
-                                        0,
-                                        subface);
-
-  for (unsigned int i = 0; i < source_fe.n_dofs_per_face(face_no); ++i)
-    {
-      const Point<dim> &p = subface_projection.point(i);
-
-      for (unsigned int j = 0; j < this->n_dofs_per_face(face_no); ++j)
-        {
-          double matrix_entry =
-            this->shape_value_component(this->face_to_cell_index(j, 0), p, 0);
-
-          // Correct the interpolated value. I.e. if it is close to 1 or 0,
-          // make it exactly 1 or 0. Unfortunately, this is required to avoid
-          // problems with higher order elements.
-          if (std::fabs(matrix_entry - 1.0) < eps)
-            matrix_entry = 1.0;
-          if (std::fabs(matrix_entry) < eps)
-            matrix_entry = 0.0;
-
-          interpolation_matrix(i, j) = matrix_entry;
-        }
-    }
-
-#ifdef DEBUG
-  // make sure that the row sum of each of the matrices is 1 at this
-  // point. this must be so since the shape functions sum up to 1
-  for (unsigned int j = 0; j < source_fe.n_dofs_per_face(face_no); ++j)
-    {
-      double sum = 0.;
+  fill_face_interpolation_matrix(x_source_fe,
+                                 numbers::invalid_unsigned_int,
+                                 interpolation_matrix,
+                                 face_no);
+}
 
-      for (unsigned int i = 0; i < this->n_dofs_per_face(face_no); ++i)
-        sum += interpolation_matrix(j, i);
 
-      Assert(std::fabs(sum - 1) < 2e-13 * this->degree * (dim - 1),
-             ExcInternalError());
-    }
-#endif
+template <int dim>
+void
+FE_RaviartThomasNodal<dim>::get_subface_interpolation_matrix(
+  const FiniteElement<dim> &x_source_fe,
+  const unsigned int        subface,
+  FullMatrix<double> &      interpolation_matrix,
+  const unsigned int        face_no) const
+{
+  fill_face_interpolation_matrix(x_source_fe,
+                                 subface,
+                                 interpolation_matrix,
+                                 face_no);
 }
 
 
@@ -1041,7 +1743,11 @@ FE_RaviartThomasNodal<dim>::get_prolongation_matrix(
            "Prolongation matrices are only available for refined cells!"));
   AssertIndexRange(child, GeometryInfo<dim>::n_children(refinement_case));
 
-  // initialization upon first request
+  // initialization upon first request, with the double-checked locking
+  // pattern used for all lazily computed matrices of the finite element
+  // classes. A std::once_flag per slot would make the fast path a single
+  // acquire load, but std::once_flag is neither copyable nor movable and
+  // finite elements must remain copyable for clone(), so the mutex stays.
   if (this->prolongation[refinement_case - 1][child].n() == 0)
     {
       std::lock_guard<std::mutex> lock(this->mutex);
@@ -1057,26 +1763,48 @@ FE_RaviartThomasNodal<dim>::get_prolongation_matrix(
         const_cast<FE_RaviartThomasNodal<dim> &>(*this);
       if (refinement_case == RefinementCase<dim>::isotropic_refinement)
         {
+          // size the per-child scratch matrices directly instead of
+          // copy-constructing them from a zero-filled prototype, which
+          // would allocate and copy one extra matrix worth of zeros
           std::vector<std::vector<FullMatrix<double>>> isotropic_matrices(
             RefinementCase<dim>::isotropic_refinement);
           isotropic_matrices.back().resize(
-            GeometryInfo<dim>::n_children(RefinementCase<dim>(refinement_case)),
-            FullMatrix<double>(this->n_dofs_per_cell(),
-                               this->n_dofs_per_cell()));
+            GeometryInfo<dim>::n_children(
+              RefinementCase<dim>(refinement_case)));
+          for (FullMatrix<double> &matrix : isotropic_matrices.back())
+            matrix.reinit(this->n_dofs_per_cell(), this->n_dofs_per_cell());
           FETools::compute_embedding_matrices(*this, isotropic_matrices, true);
           this_nonconst.prolongation[refinement_case - 1].swap(
             isotropic_matrices.back());
         }
       else
         {
-          // must compute both restriction and prolongation matrices because
-          // we only check for their size and the reinit call initializes them
-          // all
-          this_nonconst.reinit_restriction_and_prolongation_matrices();
-          FETools::compute_embedding_matrices(*this,
-                                              this_nonconst.prolongation);
-          FETools::compute_projection_matrices(*this,
-                                               this_nonconst.restriction);
+          // compute into scratch storage covering all refinement cases and
+          // swap in only the per-case families that are still marked as not
+          // yet computed, i.e. whose matrices have size zero. Families
+          // published earlier -- typically the isotropic one, filled by the
+          // branch above -- keep their storage, so they are neither
+          // reallocated a second time nor refilled in place while readers
+          // on the unlocked fast path may be accessing them.
+          std::vector<std::vector<FullMatrix<double>>> scratch(
+            RefinementCase<dim>::isotropic_refinement);
+          for (unsigned int ref_case = RefinementCase<dim>::cut_x;
+               ref_case <= RefinementCase<dim>::isotropic_refinement;
+               ++ref_case)
+            {
+              scratch[ref_case - 1].resize(
+                GeometryInfo<dim>::n_children(RefinementCase<dim>(ref_case)));
+              for (FullMatrix<double> &matrix : scratch[ref_case - 1])
+                matrix.reinit(this->n_dofs_per_cell(),
+                              this->n_dofs_per_cell());
+            }
+          FETools::compute_embedding_matrices(*this, scratch);
+          for (unsigned int ref_case = RefinementCase<dim>::cut_x;
+               ref_case <= RefinementCase<dim>::isotropic_refinement;
+               ++ref_case)
+            if (this_nonconst.prolongation[ref_case - 1][0].n() == 0)
+              this_nonconst.prolongation[ref_case - 1].swap(
+                scratch[ref_case - 1]);
         }
     }
 
@@ -1099,7 +1827,8 @@ FE_RaviartThomasNodal<dim>::get_restriction_matrix(
            "Restriction matrices are only available for refined cells!"));
   AssertIndexRange(child, GeometryInfo<dim>::n_children(refinement_case));
 
-  // initialization upon first request
+  // initialization upon first request; see get_prolongation_matrix() for
+  // why this is double-checked locking rather than std::call_once
   if (this->restriction[refinement_case - 1][child].n() == 0)
     {
       std::lock_guard<std::mutex> lock(this->mutex);
@@ -1115,26 +1844,43 @@ FE_RaviartThomasNodal<dim>::get_restriction_matrix(
         const_cast<FE_RaviartThomasNodal<dim> &>(*this);
       if (refinement_case == RefinementCase<dim>::isotropic_refinement)
         {
+          // see get_prolongation_matrix() for why the scratch matrices are
+          // sized in place rather than copied from a prototype
           std::vector<std::vector<FullMatrix<double>>> isotropic_matrices(
             RefinementCase<dim>::isotropic_refinement);
           isotropic_matrices.back().resize(
-            GeometryInfo<dim>::n_children(RefinementCase<dim>(refinement_case)),
-            FullMatrix<double>(this->n_dofs_per_cell(),
-                               this->n_dofs_per_cell()));
+            GeometryInfo<dim>::n_children(
+              RefinementCase<dim>(refinement_case)));
+          for (FullMatrix<double> &matrix : isotropic_matrices.back())
+            matrix.reinit(this->n_dofs_per_cell(), this->n_dofs_per_cell());
           FETools::compute_projection_matrices(*this, isotropic_matrices, true);
           this_nonconst.restriction[refinement_case - 1].swap(
             isotropic_matrices.back());
         }
       else
         {
-          // must compute both restriction and prolongation matrices because
-          // we only check for their size and the reinit call initializes them
-          // all
-          this_nonconst.reinit_restriction_and_prolongation_matrices();
-          FETools::compute_embedding_matrices(*this,
-                                              this_nonconst.prolongation);
-          FETools::compute_projection_matrices(*this,
-                                               this_nonconst.restriction);
+          // compute into scratch storage and swap in only the per-case
+          // families still at size zero; see get_prolongation_matrix()
+          // above for the rationale
+          std::vector<std::vector<FullMatrix<double>>> scratch(
+            RefinementCase<dim>::isotropic_refinement);
+          for (unsigned int ref_case = RefinementCase<dim>::cut_x;
+               ref_case <= RefinementCase<dim>::isotropic_refinement;
+               ++ref_case)
+            {
+              scratch[ref_case - 1].resize(
+                GeometryInfo<dim>::n_children(RefinementCase<dim>(ref_case)));
+              for (FullMatrix<double> &matrix : scratch[ref_case - 1])
+                matrix.reinit(this->n_dofs_per_cell(),
+                              this->n_dofs_per_cell());
+            }
+          FETools::compute_projection_matrices(*this, scratch);
+          for (unsigned int ref_case = RefinementCase<dim>::cut_x;
+               ref_case <= RefinementCase<dim>::isotropic_refinement;
+               ++ref_case)
+            if (this_nonconst.restriction[ref_case - 1][0].n() == 0)
+              this_nonconst.restriction[ref_case - 1].swap(
+                scratch[ref_case - 1]);
         }
     }
 